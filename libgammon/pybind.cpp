@@ -207,6 +207,12 @@ class Game : public Stringer {
         return backgammon_game_can_bear_off(m_game, color);
     }
 
+    int pip_count(backgammon_color_t color) const {
+        return backgammon_game_pip_count(m_game, color);
+    }
+
+    bool is_contact() const { return backgammon_game_is_contact(m_game); }
+
     Result result() const {
         backgammon_result_t x = backgammon_game_result(m_game);
         Result result;
@@ -321,6 +327,8 @@ PYBIND11_MODULE(_libgammon, mod) {
         .def("can_move", &Game::can_move)
         .def("move", &Game::move)
         .def("can_bear_off", &Game::can_bear_off)
+        .def("pip_count", &Game::pip_count)
+        .def("is_contact", &Game::is_contact)
         .def("result", &Game::result)
         .def("get_opponent", &Game::get_opponent)
         .def("save_state", &Game::save_state)
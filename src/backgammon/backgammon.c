@@ -1,16 +1,16 @@
 #include <assert.h>
+#include <stdint.h>
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
 
 #include "backgammon.h"
+#include "internal.h"
 
-/**
- * @brief 游戏状态
- */
-typedef struct backgammon_game_t {
-    backgammon_grid_t board[BACKGAMMON_NUM_POSITIONS]; /* 棋盘各个位置的信息 */
-} backgammon_game_t;
+const int backgammon_rolls[BACKGAMMON_NUM_ROLLS][BACKGAMMON_NUM_DICES] = {
+    {1, 1}, {1, 2}, {1, 3}, {1, 4}, {1, 5}, {1, 6}, {2, 2}, {2, 3}, {2, 4}, {2, 5}, {2, 6},
+    {3, 3}, {3, 4}, {3, 5}, {3, 6}, {4, 4}, {4, 5}, {4, 6}, {5, 5}, {5, 6}, {6, 6},
+};
 
 static backgammon_grid_t backgammon_make_grid(backgammon_color_t color, int count) {
     backgammon_grid_t grid;
@@ -48,6 +48,67 @@ static int backgammon_is_off_pos(int pos) {
     return pos == BACKGAMMON_WHITE_OFF_POS || pos == BACKGAMMON_BLACK_OFF_POS;
 }
 
+static int backgammon_color_index(backgammon_color_t color) {
+    return color == BACKGAMMON_WHITE ? 0 : 1;
+}
+
+/**
+ * @brief 指定位置上的棋子距离 off 位置的点数，bar 上的棋子为 25，已 bear off 的棋子为 0
+ */
+static int backgammon_pip_distance(backgammon_color_t color, int pos) {
+    if (backgammon_is_off_pos(pos)) {
+        return 0;
+    }
+    return color == BACKGAMMON_WHITE ? pos : BACKGAMMON_WHITE_BAR_POS - pos;
+}
+
+/**
+ * @brief 从 pos 开始向 off 方向查找指定玩家最靠后的棋子位置，没有棋子时返回对应 off 方向的
+ * 棋盘外位置（白方为 0，黑方为 25），这样双方没有接触当且仅当 back[白] < back[黑]
+ */
+static int backgammon_find_back_pos(const backgammon_game_t *game, backgammon_color_t color,
+                                    int pos) {
+    if (color == BACKGAMMON_WHITE) {
+        for (; pos >= BACKGAMMON_BOARD_MIN_POS; --pos) {
+            if (game->board[pos].color == color && game->board[pos].count > 0) {
+                return pos;
+            }
+        }
+        return BACKGAMMON_BLACK_BAR_POS;
+    }
+    for (; pos <= BACKGAMMON_BOARD_MAX_POS; ++pos) {
+        if (game->board[pos].color == color && game->board[pos].count > 0) {
+            return pos;
+        }
+    }
+    return BACKGAMMON_WHITE_BAR_POS;
+}
+
+/**
+ * @brief 根据棋盘重新计算双方点数和最靠后棋子位置
+ */
+static void backgammon_game_update_stats(backgammon_game_t *game) {
+    const backgammon_color_t colors[2] = {BACKGAMMON_WHITE, BACKGAMMON_BLACK};
+    for (int i = 0; i < 2; ++i) {
+        const backgammon_color_t color = colors[i];
+        const int bar_pos = backgammon_get_bar_pos(color);
+        int pips = game->board[bar_pos].count * backgammon_pip_distance(color, bar_pos);
+        for (int pos = BACKGAMMON_BOARD_MIN_POS; pos <= BACKGAMMON_BOARD_MAX_POS; ++pos) {
+            if (game->board[pos].color == color) {
+                pips += game->board[pos].count * backgammon_pip_distance(color, pos);
+            }
+        }
+        game->pips[i] = pips;
+        if (game->board[bar_pos].count > 0) {
+            game->back[i] = bar_pos;
+        } else {
+            game->back[i] = backgammon_find_back_pos(
+                game, color,
+                color == BACKGAMMON_WHITE ? BACKGAMMON_BOARD_MAX_POS : BACKGAMMON_BOARD_MIN_POS);
+        }
+    }
+}
+
 static int backgammon_add_moves(backgammon_color_t color, int pos, int moves, int *hit_off) {
     if (color == BACKGAMMON_WHITE) {
         pos -= moves;
@@ -78,6 +139,7 @@ backgammon_game_t *backgammon_game_new_with_board(const backgammon_grid_t *grids
     for (size_t i = 0; i < size; ++i) {
         game->board[positions[i]] = grids[i];
     }
+    backgammon_game_update_stats(game);
     return game;
 }
 
@@ -93,6 +155,7 @@ void backgammon_game_reset(struct backgammon_game_t *game) {
     game->board[BACKGAMMON_BOARD_MIN_POS + 11] = backgammon_make_grid(BACKGAMMON_BLACK, 5);
     game->board[BACKGAMMON_BOARD_MIN_POS + 16] = backgammon_make_grid(BACKGAMMON_BLACK, 3);
     game->board[BACKGAMMON_BOARD_MIN_POS + 18] = backgammon_make_grid(BACKGAMMON_BLACK, 5);
+    backgammon_game_update_stats(game);
 }
 
 backgammon_game_t *backgammon_game_clone(const struct backgammon_game_t *game) {
@@ -114,31 +177,15 @@ backgammon_grid_t backgammon_game_get_grid(const backgammon_game_t *game, int po
 
 void backgammon_game_set_grid(struct backgammon_game_t *game, int pos, backgammon_grid_t grid) {
     game->board[pos] = grid;
+    backgammon_game_update_stats(game);
 }
 
-typedef struct backgamme_game_key_t {
-    uint64_t first;
-    uint64_t second;
-} backgammon_game_key_t;
-
-static uint64_t backgammon_game_key_hash(backgammon_game_key_t key) {
-    return key.first ^ (key.second << 1);
+int backgammon_game_pip_count(const struct backgammon_game_t *game, backgammon_color_t color) {
+    return game->pips[backgammon_color_index(color)];
 }
 
-static void set_game_key_bit(backgammon_game_key_t *key, int offset, int value) {
-    uint64_t *data;
-    if (offset < 64) {
-        data = &(key->first);
-    } else {
-        offset -= 64;
-        data = &(key->second);
-    }
-    uint64_t mask = 1 << offset;
-    if (value == 1) {
-        *data = (*data) | mask;
-    } else {
-        *data = (*data) & (~mask);
-    }
+int backgammon_game_is_contact(const struct backgammon_game_t *game) {
+    return game->back[0] > game->back[1];
 }
 
 static int backgammon_is_same_key(backgammon_game_key_t key1, backgammon_game_key_t key2) {
@@ -146,22 +193,31 @@ static int backgammon_is_same_key(backgammon_game_key_t key1, backgammon_game_ke
 }
 
 backgammon_game_key_t backgammon_game_key(const backgammon_game_t *game) {
-    backgammon_game_key_t key;
-    memset(&key, 0, sizeof(key));
+    uint64_t words[2] = {0, 0};
     int offset = 0;
-    for (int pos = 0; pos < BACKGAMMON_NUM_POSITIONS; pos++) {
-        backgammon_grid_t grid = backgammon_game_get_grid(game, pos);
+    /* off 位置的棋子数可由其余位置推出，24 * 5 + 2 * 4 恰好为 128 位 */
+    for (int pos = BACKGAMMON_BLACK_BAR_POS; pos <= BACKGAMMON_WHITE_BAR_POS; pos++) {
+        const backgammon_grid_t grid = game->board[pos];
+        // marshal count (0~15) using 4 bits
+        uint64_t bits = (uint64_t)(grid.count & 0xF);
+        int num_bits = 4;
         if (pos >= BACKGAMMON_BOARD_MIN_POS && pos <= BACKGAMMON_BOARD_MAX_POS) {
             // marshal color using 1 bit
-            set_game_key_bit(&key, offset, grid.color == BACKGAMMON_WHITE);
-            offset++;
+            bits = (bits << 1) | (grid.count > 0 && grid.color == BACKGAMMON_WHITE);
+            num_bits = 5;
         }
-        // marshal count (0~15) using 4 bits
-        for (int b = 0; b < 4; b++) {
-            set_game_key_bit(&key, offset, ((grid.count > b) & 0x1) == 0);
-            offset++;
+        const int index = offset >> 6;
+        const int shift = offset & 63;
+        words[index] |= bits << shift;
+        if (shift + num_bits > 64) {
+            words[index + 1] |= bits >> (64 - shift);
         }
+        offset += num_bits;
     }
+    assert(offset == 128);
+    backgammon_game_key_t key;
+    key.first = words[0];
+    key.second = words[1];
     return key;
 }
 
@@ -486,23 +542,37 @@ int backgammon_game_move(backgammon_game_t *game, backgammon_color_t color, int
     assert(game->board[from].color == color);
     assert(game->board[from].count > 0);
 
+    const int index = backgammon_color_index(color);
+    game->pips[index] -= backgammon_pip_distance(color, from) - backgammon_pip_distance(color, to);
+    int hit = 0;
     if (game->board[to].count == 0 || game->board[to].color == color) {
         /* 目标位置没有棋子或是己方棋子，则直接移动至目标位置即可 */
         game->board[to].color = color;
         game->board[to].count++;
         game->board[from].count--;
-        return 0;
-    }
-    /* 敌方在此处恰有 1 个棋子，此时攻击敌方棋子到中间条上 */
-    assert(game->board[to].count == 1);
-    const int opponent = game->board[to].color;
-    game->board[to].color = color;
-    game->board[to].count = 1;
-    game->board[from].count--;
-    const int opponent_bar_pos = backgammon_get_bar_pos(opponent);
-    game->board[opponent_bar_pos].color = opponent;
-    game->board[opponent_bar_pos].count++;
-    return 1;
+    } else {
+        /* 敌方在此处恰有 1 个棋子，此时攻击敌方棋子到中间条上 */
+        assert(game->board[to].count == 1);
+        const backgammon_color_t opponent = game->board[to].color;
+        game->board[to].color = color;
+        game->board[to].count = 1;
+        game->board[from].count--;
+        const int opponent_bar_pos = backgammon_get_bar_pos(opponent);
+        game->board[opponent_bar_pos].color = opponent;
+        game->board[opponent_bar_pos].count++;
+        const int opponent_index = backgammon_color_index(opponent);
+        game->pips[opponent_index] += backgammon_pip_distance(opponent, opponent_bar_pos) -
+                                      backgammon_pip_distance(opponent, to);
+        game->back[opponent_index] = opponent_bar_pos;
+        hit = 1;
+    }
+    /* 最靠后的棋子离开后，向前查找新的最靠后棋子 */
+    if (from == game->back[index] && game->board[from].count == 0) {
+        const int direction = color == BACKGAMMON_WHITE ? -1 : +1;
+        game->back[index] = backgammon_find_back_pos(
+            game, color, backgammon_is_bar_pos(from) ? from + direction : from);
+    }
+    return hit;
 }
 
 int backgammon_game_can_bear_off(const backgammon_game_t *game, backgammon_color_t color) {
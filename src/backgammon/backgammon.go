@@ -1,5 +1,7 @@
 package backgammon
 
+// #cgo LDFLAGS: -lm
+// #cgo !windows LDFLAGS: -lpthread
 // #include "backgammon.h"
 // typedef struct backgammon_game_wrapper_t { struct backgammon_game_t* ptr; } backgammon_game_wrapper_t;
 import "C"
@@ -130,9 +132,9 @@ func newAction(caction *C.backgammon_action_t) *Action {
 	}
 	return &Action{
 		Move: Move{
-			From:  caction.from,
-			Steps: caction.steps,
-			To:    caction.to,
+			From:  caction.move.from,
+			Steps: caction.move.steps,
+			To:    caction.move.to,
 		},
 		Children: newAction(caction.children),
 		Sibling:  newAction(caction.sibling),
@@ -227,6 +229,16 @@ func (game *Game) SetGrid(pos int, grid Grid) {
 	C.backgammon_game_set_grid(game.wrapper.ptr, Int(pos), cgrid)
 }
 
+// PipCount retrives pip count of player `color`
+func (game *Game) PipCount(color Color) int {
+	return int(C.backgammon_game_pip_count(game.wrapper.ptr, color))
+}
+
+// IsContact reports whether checkers of two players can still hit each other
+func (game *Game) IsContact() bool {
+	return C.backgammon_game_is_contact(game.wrapper.ptr) == 1
+}
+
 // GetActions gets all legal actions
 func (game *Game) GetActions(color Color, roll1, roll2 int) *Action {
 	caction := C.backgammon_game_get_actions(game.wrapper.ptr, color, Int(roll1), Int(roll2))
@@ -100,6 +100,7 @@ typedef enum backgammon_error_t {
 
 #define BACKGAMMON_NUM_DICES 2     /* 骰子数量 */
 #define BACKGAMMON_NUM_CHECKERS 15 /* 每一方的棋子个数 */
+#define BACKGAMMON_NUM_ROLLS 21    /* 不同的骰子组合数量，其中非对子出现概率为 2/36，对子为 1/36 */
 
 #define BACKGAMMON_NUM_FEATURES 198 /* 棋盘状态特征向量元素个数 */
 
@@ -185,6 +186,27 @@ backgammon_grid_t backgammon_game_get_grid(const struct backgammon_game_t *game,
 BACKGAMMON_API
 void backgammon_game_set_grid(struct backgammon_game_t *game, int pos, backgammon_grid_t grid);
 
+/**
+ * @brief 获取指定玩家的点数（所有棋子距离 off 位置的步数之和）。点数随 backgammon_game_move
+ * 增量更新，查询为 O(1)
+ *
+ * @param game 当前游戏状态
+ * @param color 玩家棋子颜色
+ * @return int 点数
+ */
+BACKGAMMON_API
+int backgammon_game_pip_count(const struct backgammon_game_t *game, backgammon_color_t color);
+
+/**
+ * @brief 判定双方棋子是否还有接触，即是否还存在某一方的棋子位于对方最靠后棋子的后面。没有接触时
+ * 游戏进入纯竞速阶段。查询为 O(1)
+ *
+ * @param game 当前游戏状态
+ * @return int 存在接触时返回 1，否则返回 0
+ */
+BACKGAMMON_API
+int backgammon_game_is_contact(const struct backgammon_game_t *game);
+
 /**
  * @brief 获取所有合法的动作
  *
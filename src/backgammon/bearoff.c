@@ -0,0 +1,291 @@
+#include <assert.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "bearoff.h"
+#include "internal.h"
+
+#define BACKGAMMON_BEAROFF_MAX_SUCCESSORS 512
+
+/**
+ * @brief 双方 bear-off 数据库
+ */
+typedef struct backgammon_bearoff_t {
+    int num_points;    /* 覆盖的 home 位置数量 */
+    int num_checkers;  /* 覆盖的单方最多棋子数量 */
+    int num_positions; /* 单方局面数量 */
+    /* binomial[n][k] = C(n, k) */
+    int binomial[BACKGAMMON_BEAROFF_MAX_POINTS + BACKGAMMON_BEAROFF_MAX_CHECKERS + 1]
+                [BACKGAMMON_BEAROFF_MAX_POINTS + 1];
+    float *table; /* table[i * num_positions + j]: 局面 i 的玩家对局面 j 的玩家先走时的胜率 */
+} backgammon_bearoff_t;
+
+/**
+ * @brief 生成数据库时使用的临时数据
+ */
+typedef struct backgammon_bearoff_builder_t {
+    backgammon_bearoff_t *db;
+    unsigned char *counts; /* counts[i * num_points + d]: 局面 i 在距离 d + 1 处的棋子个数 */
+    int *offsets;          /* 局面 i 在骰子组合 r 下的后继局面为 successors[offsets[i*21+r]..] */
+    int *successors;
+    size_t num_successors;
+    size_t cap_successors;
+} backgammon_bearoff_builder_t;
+
+/**
+ * @brief 按组合数计算单方局面编号。将 num_points 个位置的棋子数和剩余的“空位”看作
+ * num_points + 1 个部分之和为 num_checkers 的组合，按字典序编号。
+ */
+static int backgammon_bearoff_rank(const backgammon_bearoff_t *db, const int *counts) {
+    int rank = 0;
+    int remain = db->num_checkers;
+    for (int i = 0; i < db->num_points; ++i) {
+        const int k = db->num_points - i;
+        rank += db->binomial[remain + k][k] - db->binomial[remain - counts[i] + k][k];
+        remain -= counts[i];
+    }
+    return rank;
+}
+
+int backgammon_bearoff_num_positions(const backgammon_bearoff_t *db) { return db->num_positions; }
+
+int backgammon_bearoff_index(const backgammon_bearoff_t *db, const struct backgammon_game_t *game,
+                             backgammon_color_t color) {
+    const int off_pos =
+        color == BACKGAMMON_WHITE ? BACKGAMMON_WHITE_OFF_POS : BACKGAMMON_BLACK_OFF_POS;
+    const int on_board = BACKGAMMON_NUM_CHECKERS - backgammon_game_get_grid(game, off_pos).count;
+    if (on_board > db->num_checkers) {
+        return -1;
+    }
+    int counts[BACKGAMMON_BEAROFF_MAX_POINTS];
+    int total = 0;
+    for (int d = 0; d < db->num_points; ++d) {
+        const int pos = color == BACKGAMMON_WHITE ? BACKGAMMON_BOARD_MIN_POS + d
+                                                  : BACKGAMMON_BOARD_MAX_POS - d;
+        const backgammon_grid_t grid = backgammon_game_get_grid(game, pos);
+        counts[d] = grid.color == color ? grid.count : 0;
+        total += counts[d];
+    }
+    /* 剩余棋子必须全部位于前 num_points 个 home 位置上 */
+    if (total != on_board) {
+        return -1;
+    }
+    return backgammon_bearoff_rank(db, counts);
+}
+
+int backgammon_bearoff_lookup(const backgammon_bearoff_t *db, const struct backgammon_game_t *game,
+                              backgammon_color_t color, double *win_rate) {
+    const int i = backgammon_bearoff_index(db, game, color);
+    if (i < 0) {
+        return 0;
+    }
+    const backgammon_color_t opponent =
+        color == BACKGAMMON_WHITE ? BACKGAMMON_BLACK : BACKGAMMON_WHITE;
+    const int j = backgammon_bearoff_index(db, game, opponent);
+    if (j < 0) {
+        return 0;
+    }
+    *win_rate = db->table[(size_t)i * db->num_positions + j];
+    return 1;
+}
+
+static void backgammon_bearoff_enumerate(backgammon_bearoff_builder_t *builder, int *counts,
+                                         int point, int remain) {
+    const backgammon_bearoff_t *db = builder->db;
+    if (point == db->num_points) {
+        const int rank = backgammon_bearoff_rank(db, counts);
+        assert(rank >= 0 && rank < db->num_positions);
+        for (int d = 0; d < db->num_points; ++d) {
+            builder->counts[rank * db->num_points + d] = (unsigned char)counts[d];
+        }
+        return;
+    }
+    for (int c = 0; c <= remain; ++c) {
+        counts[point] = c;
+        backgammon_bearoff_enumerate(builder, counts, point + 1, remain - c);
+    }
+    counts[point] = 0;
+}
+
+/**
+ * @brief 单方局面下使用骰子 dices 可达的所有局面编号（去重后）追加到 result 中
+ */
+static void backgammon_bearoff_walk(const backgammon_bearoff_t *db, int *counts, const int *dices,
+                                    int num_dices, int *result, int *size) {
+    int highest = -1;
+    for (int d = db->num_points - 1; d >= 0; --d) {
+        if (counts[d] > 0) {
+            highest = d;
+            break;
+        }
+    }
+    if (num_dices == 0 || highest < 0) {
+        const int rank = backgammon_bearoff_rank(db, counts);
+        for (int i = 0; i < *size; ++i) {
+            if (result[i] == rank) {
+                return;
+            }
+        }
+        assert(*size < BACKGAMMON_BEAROFF_MAX_SUCCESSORS);
+        result[(*size)++] = rank;
+        return;
+    }
+    for (int d = 0; d <= highest; ++d) {
+        if (counts[d] == 0) {
+            continue;
+        }
+        const int to = d - dices[0];
+        /* 未恰好 bear off 时，只能移动最远的棋子 */
+        if (to < -1 && d != highest) {
+            continue;
+        }
+        counts[d]--;
+        if (to >= 0) {
+            counts[to]++;
+        }
+        backgammon_bearoff_walk(db, counts, dices + 1, num_dices - 1, result, size);
+        if (to >= 0) {
+            counts[to]--;
+        }
+        counts[d]++;
+    }
+}
+
+static int backgammon_bearoff_build_successors(backgammon_bearoff_builder_t *builder) {
+    const backgammon_bearoff_t *db = builder->db;
+    const size_t num_lists = (size_t)db->num_positions * BACKGAMMON_NUM_ROLLS;
+    builder->offsets = (int *)malloc(sizeof(int) * (num_lists + 1));
+    builder->cap_successors = num_lists * 4;
+    builder->successors = (int *)malloc(sizeof(int) * builder->cap_successors);
+    if (builder->offsets == NULL || builder->successors == NULL) {
+        return 0;
+    }
+    builder->num_successors = 0;
+    int result[BACKGAMMON_BEAROFF_MAX_SUCCESSORS];
+    int counts[BACKGAMMON_BEAROFF_MAX_POINTS];
+    for (int i = 0; i < db->num_positions; ++i) {
+        for (int r = 0; r < BACKGAMMON_NUM_ROLLS; ++r) {
+            const int roll1 = backgammon_rolls[r][0];
+            const int roll2 = backgammon_rolls[r][1];
+            int size = 0;
+            for (int d = 0; d < db->num_points; ++d) {
+                counts[d] = builder->counts[i * db->num_points + d];
+            }
+            if (roll1 == roll2) {
+                const int dices[4] = {roll1, roll1, roll1, roll1};
+                backgammon_bearoff_walk(db, counts, dices, 4, result, &size);
+            } else {
+                const int dices[2] = {roll1, roll2};
+                const int revdices[2] = {roll2, roll1};
+                backgammon_bearoff_walk(db, counts, dices, 2, result, &size);
+                backgammon_bearoff_walk(db, counts, revdices, 2, result, &size);
+            }
+            if (builder->num_successors + size > builder->cap_successors) {
+                builder->cap_successors = builder->cap_successors * 2 + size;
+                int *successors =
+                    (int *)realloc(builder->successors, sizeof(int) * builder->cap_successors);
+                if (successors == NULL) {
+                    return 0;
+                }
+                builder->successors = successors;
+            }
+            builder->offsets[(size_t)i * BACKGAMMON_NUM_ROLLS + r] = (int)builder->num_successors;
+            memcpy(builder->successors + builder->num_successors, result, sizeof(int) * size);
+            builder->num_successors += size;
+        }
+    }
+    builder->offsets[num_lists] = (int)builder->num_successors;
+    return 1;
+}
+
+/**
+ * @brief 计算局面 i 的玩家面对局面 j 的玩家先走时的胜率。每次移动都会减少点数，因此递归
+ * 深度不超过双方点数之和。
+ */
+static float backgammon_bearoff_solve(backgammon_bearoff_builder_t *builder, int i, int j) {
+    backgammon_bearoff_t *db = builder->db;
+    float *value = &db->table[(size_t)i * db->num_positions + j];
+    if (*value >= 0) {
+        return *value;
+    }
+    if (i == 0) {
+        /* 当前玩家已经没有棋子，即已经获胜 */
+        *value = 1.0f;
+        return *value;
+    }
+    if (j == 0) {
+        *value = 0.0f;
+        return *value;
+    }
+    double sum = 0;
+    for (int r = 0; r < BACKGAMMON_NUM_ROLLS; ++r) {
+        const size_t list = (size_t)i * BACKGAMMON_NUM_ROLLS + r;
+        double best = 0;
+        for (int k = builder->offsets[list]; k < builder->offsets[list + 1]; ++k) {
+            const double p = 1.0 - backgammon_bearoff_solve(builder, j, builder->successors[k]);
+            if (p > best) {
+                best = p;
+            }
+        }
+        sum += best * backgammon_roll_weight(backgammon_rolls[r]);
+    }
+    *value = (float)(sum / 36.0);
+    return *value;
+}
+
+backgammon_bearoff_t *backgammon_bearoff_new(int num_points, int num_checkers) {
+    if (num_points < 1 || num_points > BACKGAMMON_BEAROFF_MAX_POINTS || num_checkers < 1 ||
+        num_checkers > BACKGAMMON_BEAROFF_MAX_CHECKERS) {
+        return NULL;
+    }
+    backgammon_bearoff_t *db = (backgammon_bearoff_t *)malloc(sizeof(backgammon_bearoff_t));
+    memset(db, 0, sizeof(backgammon_bearoff_t));
+    db->num_points = num_points;
+    db->num_checkers = num_checkers;
+    for (int n = 0; n <= num_points + num_checkers; ++n) {
+        db->binomial[n][0] = 1;
+        for (int k = 1; k <= num_points; ++k) {
+            db->binomial[n][k] = n == 0 ? 0 : db->binomial[n - 1][k - 1] + db->binomial[n - 1][k];
+        }
+    }
+    db->num_positions = db->binomial[num_points + num_checkers][num_points];
+
+    const size_t table_size = (size_t)db->num_positions * db->num_positions;
+    db->table = (float *)malloc(sizeof(float) * table_size);
+
+    backgammon_bearoff_builder_t builder;
+    memset(&builder, 0, sizeof(builder));
+    builder.db = db;
+    builder.counts = (unsigned char *)malloc((size_t)db->num_positions * num_points);
+    int ok = db->table != NULL && builder.counts != NULL;
+    if (ok) {
+        int counts[BACKGAMMON_BEAROFF_MAX_POINTS] = {0};
+        backgammon_bearoff_enumerate(&builder, counts, 0, num_checkers);
+        ok = backgammon_bearoff_build_successors(&builder);
+    }
+    if (ok) {
+        for (size_t k = 0; k < table_size; ++k) {
+            db->table[k] = -1.0f;
+        }
+        for (int i = 0; i < db->num_positions; ++i) {
+            for (int j = 0; j < db->num_positions; ++j) {
+                backgammon_bearoff_solve(&builder, i, j);
+            }
+        }
+    }
+    free(builder.counts);
+    free(builder.offsets);
+    free(builder.successors);
+    if (!ok) {
+        backgammon_bearoff_free(db);
+        return NULL;
+    }
+    return db;
+}
+
+void backgammon_bearoff_free(backgammon_bearoff_t *db) {
+    if (db) {
+        free(db->table);
+        free(db);
+    }
+}
@@ -0,0 +1,81 @@
+#ifndef _BACKGAMMON_BEAROFF_H_
+#define _BACKGAMMON_BEAROFF_H_
+
+#include "backgammon.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define BACKGAMMON_BEAROFF_MAX_POINTS 6    /* bear-off 数据库最多覆盖的 home 位置数量 */
+#define BACKGAMMON_BEAROFF_MAX_CHECKERS 15 /* bear-off 数据库最多覆盖的单方棋子数量 */
+
+/**
+ * @brief 双方 bear-off 数据库。对于双方都只剩下 home 区域前 num_points 个位置上不超过
+ * num_checkers 个棋子的局面，记录当前回合玩家的精确胜率（不考虑 cube）。
+ *
+ * 单方局面按组合数排序得到稠密编号 [0, num_positions)，双方局面的胜率存储在
+ * table[index(当前玩家) * num_positions + index(对手)] 中，因此一次查询只需要两次编号计算和
+ * 一次数组读取。
+ */
+struct backgammon_bearoff_t;
+
+/**
+ * @brief 生成 bear-off 数据库。数据库大小为 C(num_points + num_checkers, num_points) 的平方，
+ * 例如 6 个位置 × 6 个棋子时为 924 × 924 个 float。
+ *
+ * @param num_points 覆盖的 home 位置数量，取值范围 [1, BACKGAMMON_BEAROFF_MAX_POINTS]
+ * @param num_checkers 覆盖的单方最多棋子数量，取值范围 [1, BACKGAMMON_BEAROFF_MAX_CHECKERS]
+ * @return struct backgammon_bearoff_t* 参数非法或内存不足时返回 NULL
+ */
+BACKGAMMON_API
+struct backgammon_bearoff_t *backgammon_bearoff_new(int num_points, int num_checkers);
+
+/**
+ * @brief 释放 bear-off 数据库
+ *
+ * @param db bear-off 数据库
+ */
+BACKGAMMON_API
+void backgammon_bearoff_free(struct backgammon_bearoff_t *db);
+
+/**
+ * @brief 获取单方局面个数（含所有棋子都已 bear off 的空局面）
+ *
+ * @param db bear-off 数据库
+ * @return int 单方局面个数
+ */
+BACKGAMMON_API
+int backgammon_bearoff_num_positions(const struct backgammon_bearoff_t *db);
+
+/**
+ * @brief 计算指定玩家的单方局面编号
+ *
+ * @param db bear-off 数据库
+ * @param game 当前游戏状态
+ * @param color 玩家棋子颜色
+ * @return int 局面不在数据库范围内时返回 -1，否则返回 [0, num_positions) 之间的编号
+ */
+BACKGAMMON_API
+int backgammon_bearoff_index(const struct backgammon_bearoff_t *db,
+                             const struct backgammon_game_t *game, backgammon_color_t color);
+
+/**
+ * @brief 查询当前回合玩家的精确胜率
+ *
+ * @param db bear-off 数据库
+ * @param game 当前游戏状态
+ * @param color 当前回合玩家棋子颜色
+ * @param win_rate 输出当前回合玩家的胜率
+ * @return int 局面在数据库范围内时返回 1，否则返回 0
+ */
+BACKGAMMON_API
+int backgammon_bearoff_lookup(const struct backgammon_bearoff_t *db,
+                              const struct backgammon_game_t *game, backgammon_color_t color,
+                              double *win_rate);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // _BACKGAMMON_BEAROFF_H_
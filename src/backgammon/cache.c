@@ -0,0 +1,211 @@
+#include <stdatomic.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "cache.h"
+#include "internal.h"
+
+#define BACKGAMMON_CACHE_WAYS 2 /* 每个桶包含的条目个数 */
+
+/**
+ * @brief 缓存条目。所有字段都是原子变量，读写通过序列号 seq 检测并发写入（seqlock）
+ */
+typedef struct backgammon_cache_entry_t {
+    atomic_uint seq;      /* 序列号，奇数表示正在写入 */
+    atomic_uint meta;     /* bit 0: 是否有效, bit 1-2: 当前回合玩家颜色, bit 3-: 搜索层数 */
+    atomic_ullong first;  /* 局面 key 的前 64 位 */
+    atomic_ullong second; /* 局面 key 的后 64 位 */
+    atomic_ullong value;  /* 白方胜率（double 的二进制表示） */
+} backgammon_cache_entry_t;
+
+/**
+ * @brief 局面评估缓存
+ */
+typedef struct backgammon_cache_t {
+    backgammon_cache_entry_t *entries;
+    size_t num_buckets;
+    backgammon_cache_policy_t policy;
+    atomic_llong hits;
+    atomic_llong misses;
+    atomic_llong stores;
+    atomic_llong skipped;
+} backgammon_cache_t;
+
+/**
+ * @brief 条目的快照
+ */
+typedef struct backgammon_cache_slot_t {
+    unsigned int meta;
+    backgammon_game_key_t key;
+    uint64_t value;
+} backgammon_cache_slot_t;
+
+static unsigned int backgammon_cache_make_meta(backgammon_color_t color, int depth) {
+    return 1u | ((unsigned int)color << 1) | ((unsigned int)(depth < 0 ? 0 : depth) << 3);
+}
+
+static int backgammon_cache_meta_depth(unsigned int meta) { return (int)(meta >> 3); }
+
+/**
+ * @brief 读取条目快照，条目正在被写入或读取期间被修改时返回 0
+ */
+static int backgammon_cache_read(backgammon_cache_entry_t *entry, backgammon_cache_slot_t *slot) {
+    const unsigned int seq = atomic_load_explicit(&entry->seq, memory_order_acquire);
+    if (seq & 1u) {
+        return 0;
+    }
+    slot->meta = atomic_load_explicit(&entry->meta, memory_order_relaxed);
+    slot->key.first = atomic_load_explicit(&entry->first, memory_order_relaxed);
+    slot->key.second = atomic_load_explicit(&entry->second, memory_order_relaxed);
+    slot->value = atomic_load_explicit(&entry->value, memory_order_relaxed);
+    atomic_thread_fence(memory_order_acquire);
+    return atomic_load_explicit(&entry->seq, memory_order_relaxed) == seq;
+}
+
+/**
+ * @brief 写入条目，其他线程正在写入同一条目时放弃并返回 0
+ */
+static int backgammon_cache_write(backgammon_cache_entry_t *entry,
+                                  const backgammon_cache_slot_t *slot) {
+    unsigned int seq = atomic_load_explicit(&entry->seq, memory_order_relaxed);
+    if ((seq & 1u) ||
+        !atomic_compare_exchange_strong_explicit(&entry->seq, &seq, seq + 1, memory_order_acquire,
+                                                 memory_order_relaxed)) {
+        return 0;
+    }
+    atomic_thread_fence(memory_order_release);
+    atomic_store_explicit(&entry->meta, slot->meta, memory_order_relaxed);
+    atomic_store_explicit(&entry->first, slot->key.first, memory_order_relaxed);
+    atomic_store_explicit(&entry->second, slot->key.second, memory_order_relaxed);
+    atomic_store_explicit(&entry->value, slot->value, memory_order_relaxed);
+    atomic_store_explicit(&entry->seq, seq + 2, memory_order_release);
+    return 1;
+}
+
+static int backgammon_cache_match(const backgammon_cache_slot_t *slot, backgammon_game_key_t key,
+                                  backgammon_color_t color) {
+    return (slot->meta & 1u) && ((slot->meta >> 1) & 3u) == (unsigned int)color &&
+           slot->key.first == key.first && slot->key.second == key.second;
+}
+
+backgammon_cache_t *backgammon_cache_new(size_t num_entries, backgammon_cache_policy_t policy) {
+    size_t num_buckets = 1;
+    while (num_buckets * BACKGAMMON_CACHE_WAYS < num_entries) {
+        num_buckets <<= 1;
+    }
+    backgammon_cache_t *cache = (backgammon_cache_t *)malloc(sizeof(backgammon_cache_t));
+    if (cache == NULL) {
+        return NULL;
+    }
+    cache->entries = (backgammon_cache_entry_t *)malloc(sizeof(backgammon_cache_entry_t) *
+                                                        num_buckets * BACKGAMMON_CACHE_WAYS);
+    if (cache->entries == NULL) {
+        free(cache);
+        return NULL;
+    }
+    cache->num_buckets = num_buckets;
+    cache->policy = policy;
+    backgammon_cache_clear(cache);
+    return cache;
+}
+
+void backgammon_cache_free(backgammon_cache_t *cache) {
+    if (cache) {
+        free(cache->entries);
+        free(cache);
+    }
+}
+
+void backgammon_cache_clear(backgammon_cache_t *cache) {
+    const size_t num_entries = cache->num_buckets * BACKGAMMON_CACHE_WAYS;
+    for (size_t i = 0; i < num_entries; ++i) {
+        backgammon_cache_entry_t *entry = &cache->entries[i];
+        atomic_init(&entry->seq, 0);
+        atomic_init(&entry->meta, 0);
+        atomic_init(&entry->first, 0);
+        atomic_init(&entry->second, 0);
+        atomic_init(&entry->value, 0);
+    }
+    atomic_init(&cache->hits, 0);
+    atomic_init(&cache->misses, 0);
+    atomic_init(&cache->stores, 0);
+    atomic_init(&cache->skipped, 0);
+}
+
+int backgammon_cache_lookup(backgammon_cache_t *cache, const backgammon_game_t *game,
+                            backgammon_color_t color, int depth, double *value) {
+    const backgammon_game_key_t key = backgammon_game_key(game);
+    const uint64_t hash = backgammon_game_key_hash(key);
+    backgammon_cache_entry_t *bucket =
+        &cache->entries[(hash & (cache->num_buckets - 1)) * BACKGAMMON_CACHE_WAYS];
+    for (int way = 0; way < BACKGAMMON_CACHE_WAYS; ++way) {
+        backgammon_cache_slot_t slot;
+        if (backgammon_cache_read(&bucket[way], &slot) &&
+            backgammon_cache_match(&slot, key, color) &&
+            backgammon_cache_meta_depth(slot.meta) >= depth) {
+            memcpy(value, &slot.value, sizeof(double));
+            atomic_fetch_add_explicit(&cache->hits, 1, memory_order_relaxed);
+            return 1;
+        }
+    }
+    atomic_fetch_add_explicit(&cache->misses, 1, memory_order_relaxed);
+    return 0;
+}
+
+void backgammon_cache_store(backgammon_cache_t *cache, const backgammon_game_t *game,
+                            backgammon_color_t color, int depth, double value) {
+    backgammon_cache_slot_t slot;
+    slot.key = backgammon_game_key(game);
+    slot.meta = backgammon_cache_make_meta(color, depth);
+    memcpy(&slot.value, &value, sizeof(double));
+    const uint64_t hash = backgammon_game_key_hash(slot.key);
+    backgammon_cache_entry_t *bucket =
+        &cache->entries[(hash & (cache->num_buckets - 1)) * BACKGAMMON_CACHE_WAYS];
+
+    /* 选择被替换的条目：相同局面 > 空条目 > 按替换策略选择 */
+    int victim = -1;
+    int empty = -1;
+    int shallowest = -1;
+    int shallowest_depth = 0;
+    for (int way = 0; way < BACKGAMMON_CACHE_WAYS && victim < 0; ++way) {
+        backgammon_cache_slot_t old;
+        if (!backgammon_cache_read(&bucket[way], &old)) {
+            continue;
+        }
+        if (backgammon_cache_match(&old, slot.key, color)) {
+            if (cache->policy == BACKGAMMON_CACHE_REPLACE_DEPTH &&
+                backgammon_cache_meta_depth(old.meta) > depth) {
+                return;
+            }
+            victim = way;
+        } else if (!(old.meta & 1u)) {
+            if (empty < 0) {
+                empty = way;
+            }
+        } else if (shallowest < 0 || backgammon_cache_meta_depth(old.meta) < shallowest_depth) {
+            shallowest = way;
+            shallowest_depth = backgammon_cache_meta_depth(old.meta);
+        }
+    }
+    if (victim < 0) {
+        if (empty >= 0) {
+            victim = empty;
+        } else if (cache->policy == BACKGAMMON_CACHE_REPLACE_DEPTH && shallowest >= 0) {
+            victim = shallowest;
+        } else {
+            victim = (int)((hash >> 32) % BACKGAMMON_CACHE_WAYS);
+        }
+    }
+    if (backgammon_cache_write(&bucket[victim], &slot)) {
+        atomic_fetch_add_explicit(&cache->stores, 1, memory_order_relaxed);
+    } else {
+        atomic_fetch_add_explicit(&cache->skipped, 1, memory_order_relaxed);
+    }
+}
+
+void backgammon_cache_get_stats(const backgammon_cache_t *cache, backgammon_cache_stats_t *stats) {
+    stats->hits = atomic_load_explicit(&cache->hits, memory_order_relaxed);
+    stats->misses = atomic_load_explicit(&cache->misses, memory_order_relaxed);
+    stats->stores = atomic_load_explicit(&cache->stores, memory_order_relaxed);
+    stats->skipped = atomic_load_explicit(&cache->skipped, memory_order_relaxed);
+}
@@ -0,0 +1,105 @@
+#ifndef _BACKGAMMON_CACHE_H_
+#define _BACKGAMMON_CACHE_H_
+
+#include "backgammon.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief 缓存替换策略。每个局面映射到一个包含 2 个条目的桶，桶满时按策略选择被替换的条目
+ */
+typedef enum backgammon_cache_policy_t {
+    BACKGAMMON_CACHE_REPLACE_ALWAYS = 0, /* 总是替换（按哈希值选择桶内条目），最新的结果优先 */
+    BACKGAMMON_CACHE_REPLACE_DEPTH = 1,  /* 优先替换搜索层数较浅的条目，深层搜索结果优先 */
+} backgammon_cache_policy_t;
+
+/**
+ * @brief 缓存统计信息
+ */
+typedef struct backgammon_cache_stats_t {
+    long long hits;    /* 命中次数 */
+    long long misses;  /* 未命中次数 */
+    long long stores;  /* 写入次数 */
+    long long skipped; /* 因其他线程正在写入同一条目而放弃的写入次数 */
+} backgammon_cache_stats_t;
+
+/**
+ * @brief 固定大小的局面评估缓存（置换表），以局面 key 和当前回合玩家作为键，记录白方胜率以及
+ * 得到该值的搜索层数（静态评估为 0 层）。
+ *
+ * 缓存是无锁的：每个条目使用序列号保护，读取时若发现条目正在被写入则视为未命中，写入时若条目
+ * 正在被其他线程写入则放弃本次写入，因此可以直接在多个线程之间共享。
+ */
+struct backgammon_cache_t;
+
+/**
+ * @brief 创建缓存
+ *
+ * @param num_entries 条目个数，向上取整为 2 的幂
+ * @param policy 替换策略
+ * @return struct backgammon_cache_t*
+ */
+BACKGAMMON_API
+struct backgammon_cache_t *backgammon_cache_new(size_t num_entries,
+                                                backgammon_cache_policy_t policy);
+
+/**
+ * @brief 释放缓存
+ *
+ * @param cache 缓存
+ */
+BACKGAMMON_API
+void backgammon_cache_free(struct backgammon_cache_t *cache);
+
+/**
+ * @brief 清空所有条目和统计信息，调用时不能有其他线程正在使用缓存
+ *
+ * @param cache 缓存
+ */
+BACKGAMMON_API
+void backgammon_cache_clear(struct backgammon_cache_t *cache);
+
+/**
+ * @brief 查询局面评估值
+ *
+ * @param cache 缓存
+ * @param game 当前游戏状态
+ * @param color 当前回合玩家棋子颜色
+ * @param depth 要求的最小搜索层数，层数更深的结果同样可用
+ * @param value 输出白方胜率
+ * @return int 命中时返回 1，否则返回 0
+ */
+BACKGAMMON_API
+int backgammon_cache_lookup(struct backgammon_cache_t *cache, const struct backgammon_game_t *game,
+                            backgammon_color_t color, int depth, double *value);
+
+/**
+ * @brief 写入局面评估值
+ *
+ * @param cache 缓存
+ * @param game 当前游戏状态
+ * @param color 当前回合玩家棋子颜色
+ * @param depth 得到该值的搜索层数
+ * @param value 白方胜率
+ */
+BACKGAMMON_API
+void backgammon_cache_store(struct backgammon_cache_t *cache, const struct backgammon_game_t *game,
+                            backgammon_color_t color, int depth, double value);
+
+/**
+ * @brief 获取统计信息
+ *
+ * @param cache 缓存
+ * @param stats 输出统计信息
+ */
+BACKGAMMON_API
+void backgammon_cache_get_stats(const struct backgammon_cache_t *cache,
+                                backgammon_cache_stats_t *stats);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // _BACKGAMMON_CACHE_H_
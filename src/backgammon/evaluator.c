@@ -0,0 +1,167 @@
+#include <math.h>
+#include <stdatomic.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "evaluator.h"
+
+/**
+ * @brief 局面评估器
+ */
+typedef struct backgammon_evaluator_t {
+    backgammon_network_fn network;
+    void *ctx;
+    const struct backgammon_bearoff_t *bearoff;
+    struct backgammon_cache_t *cache;
+    atomic_llong counts[BACKGAMMON_NUM_POSITION_CLASSES];
+    atomic_llong network_calls;
+} backgammon_evaluator_t;
+
+static backgammon_color_t backgammon_evaluator_opponent(backgammon_color_t color) {
+    return color == BACKGAMMON_WHITE ? BACKGAMMON_BLACK : BACKGAMMON_WHITE;
+}
+
+backgammon_evaluator_t *backgammon_evaluator_new(backgammon_network_fn network, void *ctx,
+                                                 const struct backgammon_bearoff_t *bearoff) {
+    backgammon_evaluator_t *evaluator =
+        (backgammon_evaluator_t *)malloc(sizeof(backgammon_evaluator_t));
+    evaluator->network = network;
+    evaluator->ctx = ctx;
+    evaluator->bearoff = bearoff;
+    evaluator->cache = NULL;
+    for (int c = 0; c < BACKGAMMON_NUM_POSITION_CLASSES; ++c) {
+        atomic_init(&evaluator->counts[c], 0);
+    }
+    atomic_init(&evaluator->network_calls, 0);
+    return evaluator;
+}
+
+void backgammon_evaluator_free(backgammon_evaluator_t *evaluator) {
+    if (evaluator) {
+        free(evaluator);
+    }
+}
+
+void backgammon_evaluator_set_cache(backgammon_evaluator_t *evaluator,
+                                    struct backgammon_cache_t *cache) {
+    evaluator->cache = cache;
+}
+
+struct backgammon_cache_t *backgammon_evaluator_get_cache(const backgammon_evaluator_t *evaluator) {
+    return evaluator->cache;
+}
+
+double backgammon_race_win_rate(const struct backgammon_game_t *game, backgammon_color_t color) {
+    const int pips = backgammon_game_pip_count(game, color);
+    const int opponent_pips =
+        backgammon_game_pip_count(game, backgammon_evaluator_opponent(color));
+    const double d = (double)(opponent_pips - pips) + 4.0;
+    double s = (double)(opponent_pips + pips) - 4.0;
+    if (s < 1.0) {
+        s = 1.0;
+    }
+    /* Φ(x) = erfc(-x / sqrt(2)) / 2 */
+    return 0.5 * erfc(-d / sqrt(2.0 * s) / sqrt(2.0));
+}
+
+/**
+ * @brief 判定局面类别，对于不需要神经网络的类别同时输出当前回合玩家的胜率
+ */
+static backgammon_position_class_t
+backgammon_evaluator_classify_with_value(const backgammon_evaluator_t *evaluator,
+                                         const struct backgammon_game_t *game,
+                                         backgammon_color_t color, double *win_rate) {
+    const backgammon_result_t result = backgammon_game_result(game);
+    if (result.winner != BACKGAMMON_NOCOLOR) {
+        *win_rate = result.winner == color ? 1.0 : 0.0;
+        return BACKGAMMON_CLASS_OVER;
+    }
+    if (backgammon_game_is_contact(game)) {
+        return BACKGAMMON_CLASS_CONTACT;
+    }
+    if (evaluator->bearoff != NULL &&
+        backgammon_bearoff_lookup(evaluator->bearoff, game, color, win_rate)) {
+        return BACKGAMMON_CLASS_BEAROFF;
+    }
+    *win_rate = backgammon_race_win_rate(game, color);
+    return BACKGAMMON_CLASS_RACE;
+}
+
+backgammon_position_class_t backgammon_evaluator_classify(const backgammon_evaluator_t *evaluator,
+                                                          const struct backgammon_game_t *game,
+                                                          backgammon_color_t color) {
+    double win_rate;
+    return backgammon_evaluator_classify_with_value(evaluator, game, color, &win_rate);
+}
+
+void backgammon_evaluator_evaluate(backgammon_evaluator_t *evaluator,
+                                   const struct backgammon_game_t *const *games,
+                                   const backgammon_color_t *colors, int n, double *outputs) {
+    long long counts[BACKGAMMON_NUM_POSITION_CLASSES] = {0};
+    int *pending = NULL;
+    int num_pending = 0;
+    for (int i = 0; i < n; ++i) {
+        double win_rate = 0;
+        backgammon_position_class_t klass =
+            backgammon_evaluator_classify_with_value(evaluator, games[i], colors[i], &win_rate);
+        if (klass == BACKGAMMON_CLASS_CONTACT) {
+            if (evaluator->network != NULL) {
+                counts[klass]++;
+                if (evaluator->cache != NULL &&
+                    backgammon_cache_lookup(evaluator->cache, games[i], colors[i], 0, &outputs[i])) {
+                    continue;
+                }
+                if (pending == NULL) {
+                    pending = (int *)malloc(sizeof(int) * n);
+                }
+                pending[num_pending++] = i;
+                continue;
+            }
+            win_rate = backgammon_race_win_rate(games[i], colors[i]);
+        }
+        counts[klass]++;
+        outputs[i] = colors[i] == BACKGAMMON_WHITE ? win_rate : 1.0 - win_rate;
+    }
+    if (num_pending > 0) {
+        /* 所有接触局面合并为一次网络调用 */
+        double *features =
+            (double *)malloc(sizeof(double) * BACKGAMMON_NUM_FEATURES * num_pending);
+        double *values = (double *)malloc(sizeof(double) * num_pending);
+        for (int k = 0; k < num_pending; ++k) {
+            backgammon_game_encode(games[pending[k]], colors[pending[k]],
+                                   features + (size_t)k * BACKGAMMON_NUM_FEATURES);
+        }
+        evaluator->network(evaluator->ctx, features, num_pending, values);
+        for (int k = 0; k < num_pending; ++k) {
+            outputs[pending[k]] = values[k];
+            if (evaluator->cache != NULL) {
+                backgammon_cache_store(evaluator->cache, games[pending[k]], colors[pending[k]], 0,
+                                       values[k]);
+            }
+        }
+        free(features);
+        free(values);
+        atomic_fetch_add_explicit(&evaluator->network_calls, 1, memory_order_relaxed);
+    }
+    free(pending);
+    for (int c = 0; c < BACKGAMMON_NUM_POSITION_CLASSES; ++c) {
+        if (counts[c] > 0) {
+            atomic_fetch_add_explicit(&evaluator->counts[c], counts[c], memory_order_relaxed);
+        }
+    }
+}
+
+void backgammon_evaluator_get_stats(const backgammon_evaluator_t *evaluator,
+                                    backgammon_evaluator_stats_t *stats) {
+    for (int c = 0; c < BACKGAMMON_NUM_POSITION_CLASSES; ++c) {
+        stats->counts[c] = atomic_load_explicit(&evaluator->counts[c], memory_order_relaxed);
+    }
+    stats->network_calls = atomic_load_explicit(&evaluator->network_calls, memory_order_relaxed);
+}
+
+void backgammon_evaluator_reset_stats(backgammon_evaluator_t *evaluator) {
+    for (int c = 0; c < BACKGAMMON_NUM_POSITION_CLASSES; ++c) {
+        atomic_store_explicit(&evaluator->counts[c], 0, memory_order_relaxed);
+    }
+    atomic_store_explicit(&evaluator->network_calls, 0, memory_order_relaxed);
+}
@@ -0,0 +1,154 @@
+#ifndef _BACKGAMMON_EVALUATOR_H_
+#define _BACKGAMMON_EVALUATOR_H_
+
+#include "backgammon.h"
+#include "bearoff.h"
+#include "cache.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief 局面类别，决定使用哪种评估方式
+ */
+typedef enum backgammon_position_class_t {
+    BACKGAMMON_CLASS_OVER = 0,    /* 游戏已结束，直接使用游戏结果 */
+    BACKGAMMON_CLASS_BEAROFF = 1, /* 双方都在 bear-off 数据库范围内，查表得到精确胜率 */
+    BACKGAMMON_CLASS_RACE = 2,    /* 双方已无接触，使用竞速公式估算胜率 */
+    BACKGAMMON_CLASS_CONTACT = 3, /* 双方仍有接触，使用神经网络评估 */
+    BACKGAMMON_NUM_POSITION_CLASSES = 4,
+} backgammon_position_class_t;
+
+/**
+ * @brief 批量评估神经网络的回调函数原型
+ *
+ * @param ctx 自定义透传上下文参数
+ * @param features batch_size 个局面的 TD-Gammon 编码，每个局面 BACKGAMMON_NUM_FEATURES 个元素
+ * @param batch_size 局面个数
+ * @param outputs 输出每个局面的白方胜率
+ */
+typedef void (*backgammon_network_fn)(void *ctx, const double *features, int batch_size,
+                                      double *outputs);
+
+/**
+ * @brief 评估统计信息
+ */
+typedef struct backgammon_evaluator_stats_t {
+    long long counts[BACKGAMMON_NUM_POSITION_CLASSES]; /* 各类局面的评估次数 */
+    long long network_calls;                           /* 神经网络批量调用次数 */
+} backgammon_evaluator_stats_t;
+
+/**
+ * @brief 局面评估器。按局面类别分派到开销最小的评估方式：游戏结果、bear-off 数据库、竞速公式或
+ * 神经网络。一次批量评估中所有需要神经网络的局面合并为一次网络调用。
+ *
+ * 只要网络回调函数是线程安全的，评估器就可以在多个线程中共享。
+ */
+struct backgammon_evaluator_t;
+
+/**
+ * @brief 创建评估器
+ *
+ * @param network 神经网络回调函数，为 NULL 时接触局面也使用竞速公式
+ * @param ctx 网络回调函数的透传上下文参数
+ * @param bearoff bear-off 数据库，可以为 NULL。评估器不持有数据库，需要调用方保证其生命周期
+ * @return struct backgammon_evaluator_t*
+ */
+BACKGAMMON_API
+struct backgammon_evaluator_t *backgammon_evaluator_new(backgammon_network_fn network, void *ctx,
+                                                        const struct backgammon_bearoff_t *bearoff);
+
+/**
+ * @brief 释放评估器
+ *
+ * @param evaluator 评估器
+ */
+BACKGAMMON_API
+void backgammon_evaluator_free(struct backgammon_evaluator_t *evaluator);
+
+/**
+ * @brief 设置局面评估缓存。设置后接触局面的网络评估结果按 0 层写入缓存，命中时跳过网络调用；
+ * backgammon_search_* 也会通过评估器使用该缓存记录多层搜索结果
+ *
+ * @param evaluator 评估器
+ * @param cache 评估缓存，为 NULL 时不使用缓存。评估器不持有缓存，需要调用方保证其生命周期
+ */
+BACKGAMMON_API
+void backgammon_evaluator_set_cache(struct backgammon_evaluator_t *evaluator,
+                                    struct backgammon_cache_t *cache);
+
+/**
+ * @brief 获取评估器使用的局面评估缓存
+ *
+ * @param evaluator 评估器
+ * @return struct backgammon_cache_t* 没有设置缓存时返回 NULL
+ */
+BACKGAMMON_API
+struct backgammon_cache_t *backgammon_evaluator_get_cache(
+    const struct backgammon_evaluator_t *evaluator);
+
+/**
+ * @brief 判定局面类别
+ *
+ * @param evaluator 评估器
+ * @param game 当前游戏状态
+ * @param color 当前回合玩家棋子颜色
+ * @return backgammon_position_class_t
+ */
+BACKGAMMON_API
+backgammon_position_class_t backgammon_evaluator_classify(
+    const struct backgammon_evaluator_t *evaluator, const struct backgammon_game_t *game,
+    backgammon_color_t color);
+
+/**
+ * @brief 批量评估局面
+ *
+ * @param evaluator 评估器
+ * @param games 被评估的局面
+ * @param colors 每个局面的当前回合玩家棋子颜色
+ * @param n 局面个数
+ * @param outputs 输出每个局面的白方胜率，与神经网络的输出含义一致
+ */
+BACKGAMMON_API
+void backgammon_evaluator_evaluate(struct backgammon_evaluator_t *evaluator,
+                                   const struct backgammon_game_t *const *games,
+                                   const backgammon_color_t *colors, int n, double *outputs);
+
+/**
+ * @brief 使用竞速公式估算当前回合玩家的胜率。公式为 Kleinman count:
+ *
+ *      P = Φ((D + 4) / sqrt(2 * (S - 4)))
+ *
+ * 其中 D 为对手点数减去当前玩家点数，S 为双方点数之和，4 近似于先走一方的优势。
+ *
+ * @param game 当前游戏状态
+ * @param color 当前回合玩家棋子颜色
+ * @return double 当前回合玩家的胜率
+ */
+BACKGAMMON_API
+double backgammon_race_win_rate(const struct backgammon_game_t *game, backgammon_color_t color);
+
+/**
+ * @brief 获取评估统计信息
+ *
+ * @param evaluator 评估器
+ * @param stats 输出统计信息
+ */
+BACKGAMMON_API
+void backgammon_evaluator_get_stats(const struct backgammon_evaluator_t *evaluator,
+                                    backgammon_evaluator_stats_t *stats);
+
+/**
+ * @brief 清空评估统计信息
+ *
+ * @param evaluator 评估器
+ */
+BACKGAMMON_API
+void backgammon_evaluator_reset_stats(struct backgammon_evaluator_t *evaluator);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // _BACKGAMMON_EVALUATOR_H_
@@ -0,0 +1,101 @@
+#ifndef _BACKGAMMON_INTERNAL_H_
+#define _BACKGAMMON_INTERNAL_H_
+
+/**
+ * 库内部各模块共享的定义，不属于公开接口。
+ */
+
+#include <stdint.h>
+
+#include "backgammon.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief 游戏状态。其他模块可以直接在栈上构造和拷贝游戏状态，避免 backgammon_game_clone 的
+ * 内存分配
+ */
+typedef struct backgammon_game_t {
+    backgammon_grid_t board[BACKGAMMON_NUM_POSITIONS]; /* 棋盘各个位置的信息 */
+    int pips[2]; /* 双方点数（白方、黑方），随 backgammon_game_move 增量更新 */
+    int back[2]; /* 双方最靠后棋子的位置（白方、黑方），用于判定双方是否还有接触 */
+} backgammon_game_t;
+
+/**
+ * @brief 局面的 128 位 key，唯一确定棋盘上所有棋子的位置（不含当前回合玩家）
+ */
+typedef struct backgammon_game_key_t {
+    uint64_t first;
+    uint64_t second;
+} backgammon_game_key_t;
+
+/**
+ * @brief 计算局面 key
+ */
+backgammon_game_key_t backgammon_game_key(const backgammon_game_t *game);
+
+/**
+ * @brief 局面 key 的 64 位哈希值（splitmix64 混合），低位分布均匀，可直接用于哈希表下标
+ */
+static inline uint64_t backgammon_game_key_hash(backgammon_game_key_t key) {
+    uint64_t x = key.first ^ (key.second * 0x9e3779b97f4a7c15ULL);
+    x ^= x >> 30;
+    x *= 0xbf58476d1ce4e5b9ULL;
+    x ^= x >> 27;
+    x *= 0x94d049bb133111ebULL;
+    x ^= x >> 31;
+    return x;
+}
+
+/**
+ * @brief 所有不同的骰子组合 (roll1 <= roll2)
+ */
+extern const int backgammon_rolls[BACKGAMMON_NUM_ROLLS][BACKGAMMON_NUM_DICES];
+
+/**
+ * @brief 骰子组合在 36 种投掷结果中出现的次数，对子为 1，非对子为 2
+ */
+static inline int backgammon_roll_weight(const int *roll) { return roll[0] == roll[1] ? 1 : 2; }
+
+/**
+ * @brief 伪随机数生成器（splitmix64）。状态只有 64 位，可以为每一局/每一次试验单独创建，
+ * 不同的种子得到互不相关的随机数流
+ */
+typedef struct backgammon_rng_t {
+    uint64_t state;
+} backgammon_rng_t;
+
+static inline void backgammon_rng_seed(backgammon_rng_t *rng, uint64_t seed, uint64_t stream) {
+    rng->state = seed ^ (stream * 0xd1b54a32d192ed03ULL);
+}
+
+static inline uint64_t backgammon_rng_next(backgammon_rng_t *rng) {
+    uint64_t x = (rng->state += 0x9e3779b97f4a7c15ULL);
+    x = (x ^ (x >> 30)) * 0xbf58476d1ce4e5b9ULL;
+    x = (x ^ (x >> 27)) * 0x94d049bb133111ebULL;
+    return x ^ (x >> 31);
+}
+
+/**
+ * @brief 返回 [0, n) 之间的随机整数
+ */
+static inline int backgammon_rng_uniform(backgammon_rng_t *rng, int n) {
+    return (int)(((backgammon_rng_next(rng) >> 32) * (uint64_t)n) >> 32);
+}
+
+/**
+ * @brief 投掷两个骰子
+ */
+static inline void backgammon_rng_roll(backgammon_rng_t *rng, int *roll1, int *roll2) {
+    const int k = backgammon_rng_uniform(rng, 36);
+    *roll1 = k / 6 + 1;
+    *roll2 = k % 6 + 1;
+}
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // _BACKGAMMON_INTERNAL_H_
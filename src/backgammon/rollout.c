@@ -0,0 +1,239 @@
+#include <math.h>
+#include <stdatomic.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "internal.h"
+#include "rollout.h"
+#include "thread.h"
+
+#define BACKGAMMON_ROLLOUT_CHUNK_SIZE 16 /* 工作线程每次领取的试验个数 */
+
+/**
+ * @brief 一组连续试验的统计量。按试验序号分组累加后再按组号顺序汇总，结果与线程调度无关
+ */
+typedef struct backgammon_rollout_chunk_t {
+    double sum[BACKGAMMON_ROLLOUT_NUM_OUTPUTS];
+    double sum_sq[BACKGAMMON_ROLLOUT_NUM_OUTPUTS];
+} backgammon_rollout_chunk_t;
+
+/**
+ * @brief 默认走子策略的上下文
+ */
+typedef struct backgammon_rollout_search_ctx_t {
+    struct backgammon_evaluator_t *evaluator;
+    const backgammon_search_options_t *options;
+} backgammon_rollout_search_ctx_t;
+
+/**
+ * @brief 一次 rollout 的共享状态
+ */
+typedef struct backgammon_rollout_job_t {
+    const backgammon_game_t *game;
+    backgammon_color_t color;
+    const backgammon_rollout_options_t *options;
+    backgammon_policy_fn policy;
+    void *policy_ctx;
+    int stratified_plies;
+    /* 每一层对 36 种投掷结果的随机排列 */
+    int strata[BACKGAMMON_ROLLOUT_MAX_STRATIFIED_PLIES][36];
+    int num_chunks;
+    atomic_int next_chunk;
+    backgammon_rollout_chunk_t *chunks;
+} backgammon_rollout_job_t;
+
+static backgammon_color_t backgammon_rollout_opponent(backgammon_color_t color) {
+    return color == BACKGAMMON_WHITE ? BACKGAMMON_BLACK : BACKGAMMON_WHITE;
+}
+
+void backgammon_rollout_default_options(backgammon_rollout_options_t *options) {
+    options->trials = 1296;
+    options->num_threads = 0;
+    options->seed = 0;
+    options->stratified_plies = 2;
+    options->policy = NULL;
+    options->policy_ctx = NULL;
+    backgammon_search_default_options(&options->search);
+    options->search.plies = 1;
+}
+
+static int backgammon_rollout_search_policy(void *ctx, const backgammon_game_t *game,
+                                            backgammon_color_t color, int roll1, int roll2,
+                                            backgammon_move_t *action) {
+    backgammon_rollout_search_ctx_t *search = (backgammon_rollout_search_ctx_t *)ctx;
+    return backgammon_search_best_action(search->evaluator, game, color, roll1, roll2,
+                                         search->options, action, NULL);
+}
+
+/**
+ * @brief 第 trial 次试验第 ply 层的骰子。第 k 层的序号为试验序号 36 进制下前 k + 1 位之和，
+ * 保证每 36 次试验中每一层的边缘分布都是均匀的
+ */
+static void backgammon_rollout_stratified_roll(const backgammon_rollout_job_t *job, int trial,
+                                               int ply, int *roll1, int *roll2) {
+    int index = 0;
+    for (int p = 0; p <= ply; ++p) {
+        index += trial % 36;
+        trial /= 36;
+    }
+    const int k = job->strata[ply][index % 36];
+    *roll1 = k / 6 + 1;
+    *roll2 = k % 6 + 1;
+}
+
+/**
+ * @brief 完成一次试验，输出 rollout 起始玩家的各项结果
+ */
+static void backgammon_rollout_trial(const backgammon_rollout_job_t *job, int trial,
+                                     double *outputs) {
+    backgammon_game_t game;
+    memcpy(&game, job->game, sizeof(backgammon_game_t));
+    backgammon_rng_t rng;
+    backgammon_rng_seed(&rng, job->options->seed, (uint64_t)trial + 1);
+    backgammon_color_t color = job->color;
+    backgammon_result_t result = backgammon_game_result(&game);
+    for (int ply = 0; result.winner == BACKGAMMON_NOCOLOR; ++ply) {
+        int roll1, roll2;
+        if (ply < job->stratified_plies) {
+            backgammon_rollout_stratified_roll(job, trial, ply, &roll1, &roll2);
+        } else {
+            backgammon_rng_roll(&rng, &roll1, &roll2);
+        }
+        backgammon_move_t action[BACKGAMMON_MAX_ACTION_MOVES];
+        const int num_moves = job->policy(job->policy_ctx, &game, color, roll1, roll2, action);
+        for (int i = 0; i < num_moves; ++i) {
+            backgammon_game_move(&game, color, action[i].from, action[i].to);
+        }
+        color = backgammon_rollout_opponent(color);
+        result = backgammon_game_result(&game);
+    }
+    memset(outputs, 0, sizeof(double) * BACKGAMMON_ROLLOUT_NUM_OUTPUTS);
+    const int win = result.winner == job->color;
+    const int gammon = result.kind >= BACKGAMMON_WIN_GAMMON;
+    const int backgammon = result.kind >= BACKGAMMON_WIN_BACKGAMMON;
+    outputs[BACKGAMMON_ROLLOUT_WIN] = win;
+    outputs[win ? BACKGAMMON_ROLLOUT_WIN_GAMMON : BACKGAMMON_ROLLOUT_LOSE_GAMMON] = gammon;
+    outputs[win ? BACKGAMMON_ROLLOUT_WIN_BACKGAMMON : BACKGAMMON_ROLLOUT_LOSE_BACKGAMMON] =
+        backgammon;
+    outputs[BACKGAMMON_ROLLOUT_EQUITY] = (win ? 1.0 : -1.0) * (1 + gammon + backgammon);
+}
+
+static void backgammon_rollout_worker(void *arg) {
+    backgammon_rollout_job_t *job = (backgammon_rollout_job_t *)arg;
+    for (;;) {
+        const int c = atomic_fetch_add_explicit(&job->next_chunk, 1, memory_order_relaxed);
+        if (c >= job->num_chunks) {
+            break;
+        }
+        backgammon_rollout_chunk_t *chunk = &job->chunks[c];
+        memset(chunk, 0, sizeof(backgammon_rollout_chunk_t));
+        const int begin = c * BACKGAMMON_ROLLOUT_CHUNK_SIZE;
+        int end = begin + BACKGAMMON_ROLLOUT_CHUNK_SIZE;
+        if (end > job->options->trials) {
+            end = job->options->trials;
+        }
+        for (int trial = begin; trial < end; ++trial) {
+            double outputs[BACKGAMMON_ROLLOUT_NUM_OUTPUTS];
+            backgammon_rollout_trial(job, trial, outputs);
+            for (int k = 0; k < BACKGAMMON_ROLLOUT_NUM_OUTPUTS; ++k) {
+                chunk->sum[k] += outputs[k];
+                chunk->sum_sq[k] += outputs[k] * outputs[k];
+            }
+        }
+    }
+}
+
+void backgammon_rollout(struct backgammon_evaluator_t *evaluator, const backgammon_game_t *game,
+                        backgammon_color_t color, const backgammon_rollout_options_t *options,
+                        backgammon_rollout_result_t *result) {
+    backgammon_rollout_options_t default_options;
+    if (options == NULL) {
+        backgammon_rollout_default_options(&default_options);
+        options = &default_options;
+    }
+    memset(result, 0, sizeof(backgammon_rollout_result_t));
+    if (options->trials <= 0) {
+        return;
+    }
+
+    backgammon_rollout_job_t *job =
+        (backgammon_rollout_job_t *)malloc(sizeof(backgammon_rollout_job_t));
+    job->game = game;
+    job->color = color;
+    job->options = options;
+    backgammon_rollout_search_ctx_t search_ctx = {evaluator, &options->search};
+    if (options->policy != NULL) {
+        job->policy = options->policy;
+        job->policy_ctx = options->policy_ctx;
+    } else {
+        job->policy = backgammon_rollout_search_policy;
+        job->policy_ctx = &search_ctx;
+    }
+
+    /* 每一层使用由种子决定的随机排列，避免不同层的骰子之间产生固定的对应关系 */
+    job->stratified_plies = options->stratified_plies;
+    if (job->stratified_plies > BACKGAMMON_ROLLOUT_MAX_STRATIFIED_PLIES) {
+        job->stratified_plies = BACKGAMMON_ROLLOUT_MAX_STRATIFIED_PLIES;
+    }
+    backgammon_rng_t rng;
+    backgammon_rng_seed(&rng, options->seed, 0);
+    for (int ply = 0; ply < job->stratified_plies; ++ply) {
+        int *strata = job->strata[ply];
+        for (int k = 0; k < 36; ++k) {
+            strata[k] = k;
+        }
+        for (int k = 35; k > 0; --k) {
+            const int j = backgammon_rng_uniform(&rng, k + 1);
+            const int tmp = strata[k];
+            strata[k] = strata[j];
+            strata[j] = tmp;
+        }
+    }
+
+    job->num_chunks =
+        (options->trials + BACKGAMMON_ROLLOUT_CHUNK_SIZE - 1) / BACKGAMMON_ROLLOUT_CHUNK_SIZE;
+    atomic_init(&job->next_chunk, 0);
+    job->chunks = (backgammon_rollout_chunk_t *)malloc(sizeof(backgammon_rollout_chunk_t) *
+                                                       job->num_chunks);
+
+    /* 调用线程同样作为一个工作线程 */
+    int num_threads =
+        options->num_threads > 0 ? options->num_threads : backgammon_thread_hardware_concurrency();
+    if (num_threads > job->num_chunks) {
+        num_threads = job->num_chunks;
+    }
+    backgammon_thread_t *threads =
+        (backgammon_thread_t *)malloc(sizeof(backgammon_thread_t) * num_threads);
+    int num_started = 0;
+    for (int i = 1; i < num_threads; ++i) {
+        if (backgammon_thread_start(&threads[num_started], backgammon_rollout_worker, job)) {
+            num_started++;
+        }
+    }
+    backgammon_rollout_worker(job);
+    for (int i = 0; i < num_started; ++i) {
+        backgammon_thread_join(&threads[i]);
+    }
+    free(threads);
+
+    double sum[BACKGAMMON_ROLLOUT_NUM_OUTPUTS] = {0};
+    double sum_sq[BACKGAMMON_ROLLOUT_NUM_OUTPUTS] = {0};
+    for (int c = 0; c < job->num_chunks; ++c) {
+        for (int k = 0; k < BACKGAMMON_ROLLOUT_NUM_OUTPUTS; ++k) {
+            sum[k] += job->chunks[c].sum[k];
+            sum_sq[k] += job->chunks[c].sum_sq[k];
+        }
+    }
+    const double n = options->trials;
+    result->trials = options->trials;
+    for (int k = 0; k < BACKGAMMON_ROLLOUT_NUM_OUTPUTS; ++k) {
+        const double mean = sum[k] / n;
+        result->mean[k] = mean;
+        if (options->trials > 1) {
+            const double variance = (sum_sq[k] - n * mean * mean) / (n - 1);
+            result->std_error[k] = variance > 0 ? sqrt(variance / n) : 0;
+        }
+    }
+    free(job->chunks);
+    free(job);
+}
@@ -0,0 +1,101 @@
+#ifndef _BACKGAMMON_ROLLOUT_H_
+#define _BACKGAMMON_ROLLOUT_H_
+
+#include <stdint.h>
+
+#include "backgammon.h"
+#include "evaluator.h"
+#include "search.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define BACKGAMMON_ROLLOUT_MAX_STRATIFIED_PLIES 4 /* 分层骰子最多覆盖的层数（36^4 种组合） */
+
+/**
+ * @brief 走子策略的回调函数原型，需要是线程安全的
+ *
+ * @param ctx 自定义透传上下文参数
+ * @param game 当前游戏状态
+ * @param color 当前玩家棋子颜色
+ * @param roll1, roll2 投掷的 2 个骰子的点数
+ * @param action 输出选择的动作，最多 BACKGAMMON_MAX_ACTION_MOVES 个移动
+ * @return int 动作包含的移动个数，没有合法动作时返回 0
+ */
+typedef int (*backgammon_policy_fn)(void *ctx, const struct backgammon_game_t *game,
+                                    backgammon_color_t color, int roll1, int roll2,
+                                    backgammon_move_t *action);
+
+/**
+ * @brief rollout 选项
+ */
+typedef struct backgammon_rollout_options_t {
+    int trials;      /* 试验（对局）次数 */
+    int num_threads; /* 工作线程数，<= 0 表示使用所有逻辑 CPU */
+    uint64_t seed;   /* 随机种子，相同的种子和选项得到完全相同的结果，与线程数无关 */
+    /**
+     * 前若干层使用分层（准随机）骰子：每 36 次试验中第 1 层的 36 种投掷结果各出现一次，
+     * 每 36^k 次试验中前 k 层的所有骰子组合各出现一次，之后的层使用随机骰子。
+     * 最多 BACKGAMMON_ROLLOUT_MAX_STRATIFIED_PLIES 层，0 表示不分层
+     */
+    int stratified_plies;
+    /* 走子策略，为 NULL 时使用评估器按 search 选项搜索最佳动作 */
+    backgammon_policy_fn policy;
+    void *policy_ctx;                   /* 走子策略的透传上下文参数 */
+    backgammon_search_options_t search; /* 默认走子策略使用的搜索选项 */
+} backgammon_rollout_options_t;
+
+/**
+ * @brief rollout 结果的各项输出，胜率均为 rollout 起始时当前回合玩家的概率。gammon 包含
+ * backgammon
+ */
+typedef enum backgammon_rollout_output_t {
+    BACKGAMMON_ROLLOUT_WIN = 0,             /* 获胜 */
+    BACKGAMMON_ROLLOUT_WIN_GAMMON = 1,      /* 以 gammon 获胜 */
+    BACKGAMMON_ROLLOUT_WIN_BACKGAMMON = 2,  /* 以 backgammon 获胜 */
+    BACKGAMMON_ROLLOUT_LOSE_GAMMON = 3,     /* 以 gammon 落败 */
+    BACKGAMMON_ROLLOUT_LOSE_BACKGAMMON = 4, /* 以 backgammon 落败 */
+    BACKGAMMON_ROLLOUT_EQUITY = 5,          /* 不考虑倍增方块的期望得分，范围 [-3, 3] */
+    BACKGAMMON_ROLLOUT_NUM_OUTPUTS = 6,
+} backgammon_rollout_output_t;
+
+/**
+ * @brief rollout 结果
+ */
+typedef struct backgammon_rollout_result_t {
+    int trials;                                       /* 完成的试验次数 */
+    double mean[BACKGAMMON_ROLLOUT_NUM_OUTPUTS];      /* 各项输出的均值 */
+    double std_error[BACKGAMMON_ROLLOUT_NUM_OUTPUTS]; /* 各项输出均值的标准误差 */
+} backgammon_rollout_result_t;
+
+/**
+ * @brief 获取默认 rollout 选项（1296 次试验，前 2 层分层骰子，1 层搜索的默认走子策略）
+ *
+ * @param options 输出默认选项
+ */
+BACKGAMMON_API
+void backgammon_rollout_default_options(backgammon_rollout_options_t *options);
+
+/**
+ * @brief 从投掷骰子之前的局面开始，多线程对弈到游戏结束，统计胜率、gammon 率和 backgammon 率。
+ *
+ * 每次试验使用由 seed 和试验序号决定的独立随机数流，结果与线程数和线程调度无关。
+ *
+ * @param evaluator 局面评估器，options->policy 不为 NULL 时可以为 NULL
+ * @param game 当前游戏状态
+ * @param color 即将投掷骰子的玩家棋子颜色
+ * @param options rollout 选项，为 NULL 时使用默认选项
+ * @param result 输出 rollout 结果
+ */
+BACKGAMMON_API
+void backgammon_rollout(struct backgammon_evaluator_t *evaluator,
+                        const struct backgammon_game_t *game, backgammon_color_t color,
+                        const backgammon_rollout_options_t *options,
+                        backgammon_rollout_result_t *result);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // _BACKGAMMON_ROLLOUT_H_
@@ -0,0 +1,261 @@
+#include <assert.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "internal.h"
+#include "search.h"
+
+#define BACKGAMMON_SEARCH_MAX_MOVES 16384 /* 单次动作生成的移动数组长度上限 */
+
+/**
+ * @brief 某个局面在指定骰子下的所有候选动作
+ */
+typedef struct backgammon_candidates_t {
+    int size;                       /* 候选动作个数 */
+    backgammon_move_t *moves;       /* 所有动作的移动，动作之间使用 steps=0 分割 */
+    int *offsets;                   /* 第 k 个动作的移动为 moves[offsets[k]..] */
+    int *lengths;                   /* 第 k 个动作包含的移动个数 */
+    backgammon_game_t *afterstates; /* 第 k 个动作执行后的局面 */
+    double *scores;                 /* 第 k 个动作执行后当前玩家的静态评估胜率 */
+    int *order;                     /* 按 scores 从高到低排序的候选动作下标 */
+} backgammon_candidates_t;
+
+static backgammon_color_t backgammon_search_opponent(backgammon_color_t color) {
+    return color == BACKGAMMON_WHITE ? BACKGAMMON_BLACK : BACKGAMMON_WHITE;
+}
+
+void backgammon_search_default_options(backgammon_search_options_t *options) {
+    options->plies = 2;
+    options->max_candidates = 8;
+    options->threshold = 0.16;
+}
+
+static void backgammon_candidates_free(backgammon_candidates_t *candidates) {
+    free(candidates->moves);
+    free(candidates->offsets);
+    free(candidates->lengths);
+    free(candidates->afterstates);
+    free(candidates->scores);
+    free(candidates->order);
+}
+
+/**
+ * @brief 生成所有不等价的候选动作及其结果局面
+ */
+static void backgammon_candidates_generate(backgammon_candidates_t *candidates,
+                                           const backgammon_game_t *game, backgammon_color_t color,
+                                           int roll1, int roll2) {
+    memset(candidates, 0, sizeof(backgammon_candidates_t));
+    candidates->moves =
+        (backgammon_move_t *)malloc(sizeof(backgammon_move_t) * BACKGAMMON_SEARCH_MAX_MOVES);
+    const int n =
+        backgammon_game_get_non_equivalent_actions(game, candidates->moves, color, roll1, roll2);
+    assert(n <= BACKGAMMON_SEARCH_MAX_MOVES);
+    int size = 0;
+    for (int i = 0; i < n; ++i) {
+        if (candidates->moves[i].steps == 0) {
+            size++;
+        }
+    }
+    candidates->offsets = (int *)malloc(sizeof(int) * (size + 1));
+    candidates->lengths = (int *)malloc(sizeof(int) * (size + 1));
+    candidates->afterstates = (backgammon_game_t *)malloc(sizeof(backgammon_game_t) * (size + 1));
+    candidates->scores = (double *)malloc(sizeof(double) * (size + 1));
+    candidates->order = (int *)malloc(sizeof(int) * (size + 1));
+    int begin = 0;
+    for (int i = 0; i < n; ++i) {
+        if (candidates->moves[i].steps != 0) {
+            continue;
+        }
+        if (i > begin) {
+            const int k = candidates->size++;
+            candidates->offsets[k] = begin;
+            candidates->lengths[k] = i - begin;
+            backgammon_game_t *afterstate = &candidates->afterstates[k];
+            memcpy(afterstate, game, sizeof(backgammon_game_t));
+            for (int j = begin; j < i; ++j) {
+                backgammon_game_move(afterstate, color, candidates->moves[j].from,
+                                     candidates->moves[j].to);
+            }
+        }
+        begin = i + 1;
+    }
+}
+
+/**
+ * @brief 一次批量评估所有候选动作的结果局面（对手回合），得到当前玩家的胜率
+ */
+static void backgammon_candidates_evaluate(backgammon_candidates_t *candidates,
+                                           struct backgammon_evaluator_t *evaluator,
+                                           backgammon_color_t color) {
+    if (candidates->size == 0) {
+        return;
+    }
+    const backgammon_game_t **games =
+        (const backgammon_game_t **)malloc(sizeof(backgammon_game_t *) * candidates->size);
+    backgammon_color_t *colors =
+        (backgammon_color_t *)malloc(sizeof(backgammon_color_t) * candidates->size);
+    const backgammon_color_t opponent = backgammon_search_opponent(color);
+    for (int k = 0; k < candidates->size; ++k) {
+        games[k] = &candidates->afterstates[k];
+        colors[k] = opponent;
+    }
+    backgammon_evaluator_evaluate(evaluator, games, colors, candidates->size, candidates->scores);
+    for (int k = 0; k < candidates->size; ++k) {
+        if (color != BACKGAMMON_WHITE) {
+            candidates->scores[k] = 1.0 - candidates->scores[k];
+        }
+        candidates->order[k] = k;
+    }
+    free(games);
+    free(colors);
+}
+
+/**
+ * @brief 按静态评估从高到低排序，并返回过滤后需要展开的候选动作个数
+ */
+static int backgammon_candidates_filter(backgammon_candidates_t *candidates,
+                                        const backgammon_search_options_t *options) {
+    /* 插入排序：候选动作通常只有几十个 */
+    for (int i = 1; i < candidates->size; ++i) {
+        const int k = candidates->order[i];
+        int j = i - 1;
+        while (j >= 0 && candidates->scores[candidates->order[j]] < candidates->scores[k]) {
+            candidates->order[j + 1] = candidates->order[j];
+            j--;
+        }
+        candidates->order[j + 1] = k;
+    }
+    int size = candidates->size;
+    if (options->max_candidates > 0 && size > options->max_candidates) {
+        size = options->max_candidates;
+    }
+    if (options->threshold > 0) {
+        const double best = candidates->scores[candidates->order[0]];
+        for (int i = 1; i < size; ++i) {
+            if (candidates->scores[candidates->order[i]] < best - options->threshold) {
+                size = i;
+                break;
+            }
+        }
+    }
+    return size;
+}
+
+static double backgammon_search_before_roll(struct backgammon_evaluator_t *evaluator,
+                                            const backgammon_game_t *game,
+                                            backgammon_color_t color, int plies,
+                                            const backgammon_search_options_t *options);
+
+/**
+ * @brief 搜索指定骰子下的最佳动作，返回执行最佳动作后当前玩家的胜率
+ *
+ * @param best 输出最佳候选动作的下标，没有合法动作时为 -1
+ */
+static double backgammon_search_after_roll(struct backgammon_evaluator_t *evaluator,
+                                           const backgammon_game_t *game, backgammon_color_t color,
+                                           int roll1, int roll2, int plies,
+                                           const backgammon_search_options_t *options,
+                                           backgammon_candidates_t *candidates, int *best) {
+    assert(plies >= 1);
+    const backgammon_color_t opponent = backgammon_search_opponent(color);
+    backgammon_candidates_generate(candidates, game, color, roll1, roll2);
+    *best = -1;
+    if (candidates->size == 0) {
+        /* 无法移动，直接轮到对手 */
+        return 1.0 - backgammon_search_before_roll(evaluator, game, opponent, plies - 1, options);
+    }
+    backgammon_candidates_evaluate(candidates, evaluator, color);
+    const int size = backgammon_candidates_filter(candidates, options);
+    *best = candidates->order[0];
+    double best_score = candidates->scores[*best];
+    if (plies == 1) {
+        return best_score;
+    }
+    best_score = -1;
+    for (int i = 0; i < size; ++i) {
+        const int k = candidates->order[i];
+        const double score =
+            1.0 - backgammon_search_before_roll(evaluator, &candidates->afterstates[k], opponent,
+                                                plies - 1, options);
+        if (score > best_score) {
+            best_score = score;
+            *best = k;
+        }
+    }
+    return best_score;
+}
+
+static double backgammon_search_before_roll(struct backgammon_evaluator_t *evaluator,
+                                            const backgammon_game_t *game,
+                                            backgammon_color_t color, int plies,
+                                            const backgammon_search_options_t *options) {
+    const backgammon_result_t result = backgammon_game_result(game);
+    if (result.winner != BACKGAMMON_NOCOLOR) {
+        return result.winner == color ? 1.0 : 0.0;
+    }
+    if (plies <= 0) {
+        double white_win_rate;
+        backgammon_evaluator_evaluate(evaluator, &game, &color, 1, &white_win_rate);
+        return color == BACKGAMMON_WHITE ? white_win_rate : 1.0 - white_win_rate;
+    }
+    struct backgammon_cache_t *cache = backgammon_evaluator_get_cache(evaluator);
+    double white_win_rate;
+    if (cache != NULL && backgammon_cache_lookup(cache, game, color, plies, &white_win_rate)) {
+        return color == BACKGAMMON_WHITE ? white_win_rate : 1.0 - white_win_rate;
+    }
+    double sum = 0;
+    for (int r = 0; r < BACKGAMMON_NUM_ROLLS; ++r) {
+        backgammon_candidates_t candidates;
+        int best;
+        const double score =
+            backgammon_search_after_roll(evaluator, game, color, backgammon_rolls[r][0],
+                                         backgammon_rolls[r][1], plies, options, &candidates, &best);
+        backgammon_candidates_free(&candidates);
+        sum += score * backgammon_roll_weight(backgammon_rolls[r]);
+    }
+    const double win_rate = sum / 36.0;
+    if (cache != NULL) {
+        backgammon_cache_store(cache, game, color, plies,
+                               color == BACKGAMMON_WHITE ? win_rate : 1.0 - win_rate);
+    }
+    return win_rate;
+}
+
+int backgammon_search_best_action(struct backgammon_evaluator_t *evaluator,
+                                  const backgammon_game_t *game, backgammon_color_t color,
+                                  int roll1, int roll2, const backgammon_search_options_t *options,
+                                  backgammon_move_t *action, double *win_rate) {
+    backgammon_search_options_t default_options;
+    if (options == NULL) {
+        backgammon_search_default_options(&default_options);
+        options = &default_options;
+    }
+    const int plies = options->plies < 1 ? 1 : options->plies;
+    backgammon_candidates_t candidates;
+    int best;
+    const double score = backgammon_search_after_roll(evaluator, game, color, roll1, roll2, plies,
+                                                      options, &candidates, &best);
+    int num_moves = 0;
+    if (best >= 0) {
+        num_moves = candidates.lengths[best];
+        memcpy(action, candidates.moves + candidates.offsets[best],
+               sizeof(backgammon_move_t) * num_moves);
+    }
+    backgammon_candidates_free(&candidates);
+    if (win_rate != NULL) {
+        *win_rate = score;
+    }
+    return num_moves;
+}
+
+double backgammon_search_evaluate(struct backgammon_evaluator_t *evaluator,
+                                  const backgammon_game_t *game, backgammon_color_t color,
+                                  const backgammon_search_options_t *options) {
+    backgammon_search_options_t default_options;
+    if (options == NULL) {
+        backgammon_search_default_options(&default_options);
+        options = &default_options;
+    }
+    return backgammon_search_before_roll(evaluator, game, color, options->plies, options);
+}
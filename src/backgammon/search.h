@@ -0,0 +1,74 @@
+#ifndef _BACKGAMMON_SEARCH_H_
+#define _BACKGAMMON_SEARCH_H_
+
+#include "backgammon.h"
+#include "evaluator.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define BACKGAMMON_MAX_ACTION_MOVES (BACKGAMMON_NUM_DICES * 2) /* 一个动作最多包含的移动个数 */
+
+/**
+ * @brief 搜索选项
+ */
+typedef struct backgammon_search_options_t {
+    /**
+     * 搜索层数（ply），至少为 1：
+     *  1: 贪心选择，对每个候选动作的结果局面做静态评估
+     *  2: 对每个候选动作，按概率平均对手 21 种骰子下的最佳应对（对手按静态评估选择应对）
+     *  n: 对手的应对同样使用 n - 1 层搜索
+     */
+    int plies;
+    /* 每一层展开前按静态评估保留的候选动作个数上限，<= 0 表示不限制 */
+    int max_candidates;
+    /* 静态评估胜率比最佳候选低 threshold 以上的候选不再展开，<= 0 表示不按胜率过滤 */
+    double threshold;
+} backgammon_search_options_t;
+
+/**
+ * @brief 获取默认搜索选项（2 层，保留 8 个候选动作，胜率阈值 0.16）
+ *
+ * @param options 输出默认选项
+ */
+BACKGAMMON_API
+void backgammon_search_default_options(backgammon_search_options_t *options);
+
+/**
+ * @brief 搜索指定骰子下的最佳动作
+ *
+ * @param evaluator 局面评估器
+ * @param game 当前游戏状态
+ * @param color 当前玩家棋子颜色
+ * @param roll1, roll2 投掷的 2 个骰子的点数
+ * @param options 搜索选项，为 NULL 时使用默认选项
+ * @param action 输出最佳动作，需要有 BACKGAMMON_MAX_ACTION_MOVES 个元素
+ * @param win_rate 输出执行最佳动作后当前玩家的胜率，可以为 NULL
+ * @return int 最佳动作包含的移动个数，没有合法动作时返回 0
+ */
+BACKGAMMON_API
+int backgammon_search_best_action(struct backgammon_evaluator_t *evaluator,
+                                  const struct backgammon_game_t *game, backgammon_color_t color,
+                                  int roll1, int roll2, const backgammon_search_options_t *options,
+                                  backgammon_move_t *action, double *win_rate);
+
+/**
+ * @brief 评估投掷骰子之前的局面，即按概率平均 21 种骰子下的最佳动作的胜率
+ *
+ * @param evaluator 局面评估器
+ * @param game 当前游戏状态
+ * @param color 即将投掷骰子的玩家棋子颜色
+ * @param options 搜索选项，为 NULL 时使用默认选项。plies 为 0 时直接使用静态评估
+ * @return double 玩家 color 的胜率
+ */
+BACKGAMMON_API
+double backgammon_search_evaluate(struct backgammon_evaluator_t *evaluator,
+                                  const struct backgammon_game_t *game, backgammon_color_t color,
+                                  const backgammon_search_options_t *options);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // _BACKGAMMON_SEARCH_H_
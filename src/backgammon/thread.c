@@ -0,0 +1,55 @@
+#ifndef _WIN32
+#define _POSIX_C_SOURCE 200809L
+#include <unistd.h>
+#endif
+
+#include "thread.h"
+
+#ifdef _WIN32
+
+static DWORD WINAPI backgammon_thread_main(LPVOID arg) {
+    backgammon_thread_t *thread = (backgammon_thread_t *)arg;
+    thread->fn(thread->arg);
+    return 0;
+}
+
+int backgammon_thread_start(backgammon_thread_t *thread, void (*fn)(void *arg), void *arg) {
+    thread->fn = fn;
+    thread->arg = arg;
+    thread->handle = CreateThread(NULL, 0, backgammon_thread_main, thread, 0, NULL);
+    return thread->handle != NULL;
+}
+
+void backgammon_thread_join(backgammon_thread_t *thread) {
+    WaitForSingleObject(thread->handle, INFINITE);
+    CloseHandle(thread->handle);
+}
+
+int backgammon_thread_hardware_concurrency(void) {
+    SYSTEM_INFO info;
+    GetSystemInfo(&info);
+    return info.dwNumberOfProcessors > 0 ? (int)info.dwNumberOfProcessors : 1;
+}
+
+#else
+
+static void *backgammon_thread_main(void *arg) {
+    backgammon_thread_t *thread = (backgammon_thread_t *)arg;
+    thread->fn(thread->arg);
+    return NULL;
+}
+
+int backgammon_thread_start(backgammon_thread_t *thread, void (*fn)(void *arg), void *arg) {
+    thread->fn = fn;
+    thread->arg = arg;
+    return pthread_create(&thread->handle, NULL, backgammon_thread_main, thread) == 0;
+}
+
+void backgammon_thread_join(backgammon_thread_t *thread) { pthread_join(thread->handle, NULL); }
+
+int backgammon_thread_hardware_concurrency(void) {
+    const long n = sysconf(_SC_NPROCESSORS_ONLN);
+    return n > 0 ? (int)n : 1;
+}
+
+#endif
@@ -0,0 +1,57 @@
+#ifndef _BACKGAMMON_THREAD_H_
+#define _BACKGAMMON_THREAD_H_
+
+/**
+ * 库内部使用的线程封装，POSIX 平台使用 pthread，Windows 平台使用 Win32 线程。不属于公开接口。
+ */
+
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <pthread.h>
+#endif
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief 线程句柄
+ */
+typedef struct backgammon_thread_t {
+#ifdef _WIN32
+    HANDLE handle;
+#else
+    pthread_t handle;
+#endif
+    void (*fn)(void *arg);
+    void *arg;
+} backgammon_thread_t;
+
+/**
+ * @brief 启动线程执行 fn(arg)
+ *
+ * @param thread 线程句柄，在线程结束前需要保持有效
+ * @param fn 线程函数
+ * @param arg 透传给线程函数的参数
+ * @return int 成功返回 1，否则返回 0
+ */
+int backgammon_thread_start(backgammon_thread_t *thread, void (*fn)(void *arg), void *arg);
+
+/**
+ * @brief 等待线程结束
+ *
+ * @param thread 线程句柄
+ */
+void backgammon_thread_join(backgammon_thread_t *thread);
+
+/**
+ * @brief 返回可用的逻辑 CPU 个数，至少为 1
+ */
+int backgammon_thread_hardware_concurrency(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // _BACKGAMMON_THREAD_H_
@@ -33,6 +33,7 @@
 #include <onnxruntime/core/session/onnxruntime_cxx_api.h>
 
 #include "../backgammon/backgammon.h"
+#include "../backgammon/search.h"
 
 static void usage(const char *name) { printf("Usage: %s <onnx1> [onnx2] [N]\n", name); }
 
@@ -104,6 +105,14 @@ class TDGammonModel {
     double output_[1];
 };
 
+/* 供 backgammon_evaluator_t 使用的批量网络回调 */
+static void run_model(void *ctx, const double *features, int batch_size, double *outputs) {
+    TDGammonModel *model = (TDGammonModel *)ctx;
+    for (int i = 0; i < batch_size; ++i) {
+        outputs[i] = model->run(features + (size_t)i * TDGammonModel::FEATURES);
+    }
+}
+
 struct VisitorContext {
     std::shared_ptr<TDGammonModel> model{nullptr};
     backgammon_game_t *game{nullptr};
@@ -145,6 +154,7 @@ int main(int argc, char **argv) {
 
     const int verbose = 0;
     const bool enable_rev_score = true;
+    const int search_plies = 1; /* 大于 1 时使用 backgammon_search_best_action 选择动作 */
 
     /**
      * TDGammon 算法训练的模型存在不一致问题：给定一个棋盘状态 s，对应的反对称状态记为 s',
@@ -182,6 +192,14 @@ int main(int argc, char **argv) {
         return 1;
     }
 
+    struct backgammon_evaluator_t *evaluator1 =
+        backgammon_evaluator_new(run_model, model1.get(), nullptr);
+    struct backgammon_evaluator_t *evaluator2 =
+        backgammon_evaluator_new(run_model, model2.get(), nullptr);
+    backgammon_search_options_t search_options;
+    backgammon_search_default_options(&search_options);
+    search_options.plies = search_plies;
+
     /* play games */
     int white_wins = 0;
     VisitorContext context;
@@ -226,7 +244,16 @@ int main(int argc, char **argv) {
             }
 
             /* get actions */
-            int n = backgammon_game_get_non_equivalent_actions(game, moves, turn, roll[0], roll[1]);
+            int n = 0;
+            if (search_plies > 1) {
+                backgammon_move_t action[BACKGAMMON_MAX_ACTION_MOVES];
+                const int num_moves = backgammon_search_best_action(
+                    turn == BACKGAMMON_WHITE ? evaluator1 : evaluator2, game, turn, roll[0],
+                    roll[1], &search_options, action, &context.best_action_score);
+                context.best_action.assign(action, action + num_moves);
+            } else {
+                n = backgammon_game_get_non_equivalent_actions(game, moves, turn, roll[0], roll[1]);
+            }
 
             /* select action */
             int begin_index = 0;
@@ -328,5 +355,7 @@ int main(int argc, char **argv) {
     }
     printf("result: white wins %d/%d=%.1f%%\n", white_wins, N,
            (double)white_wins * 100 / (double)(N));
+    backgammon_evaluator_free(evaluator1);
+    backgammon_evaluator_free(evaluator2);
     return 0;
 }